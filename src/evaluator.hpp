@@ -0,0 +1,526 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <stdexcept>
+#include <optional>
+#include <variant>
+#include <span>
+#include <limits>
+#include <cstdint>
+#include <charconv>
+#include <cmath>
+#include "parser.hpp"
+
+using Value = std::variant<long long, double, bool, std::string>;
+
+struct Binding {
+    std::string type;
+    std::optional<Value> value; // empty once the variable depends on runtime input
+    bool declared = false;      // a residual declaration already carries this value
+};
+
+// Runs every statement that does not depend on runtime input at compile time.
+// Folded output is merged into a single pre-rendered string and only the
+// input-dependent residual program is handed to the Generator.
+class Evaluator {
+private:
+    std::unordered_map<std::string, Binding> env;
+    std::vector<ParsedStatement> residual;
+    std::string pendingOutput;
+    Token pendingAnchor;
+    long long fuelLimit;
+    long long fuel;     // steps left for the statement processBlock is folding
+    int foldedCount = 0;
+
+    // Bindings overwritten during compile-time execution, so a statement that
+    // turns out to depend on input can be rolled back without copying env
+    struct UndoEntry {
+        std::string name;
+        std::optional<Binding> previous;
+    };
+    std::vector<UndoEntry> undoLog;
+
+    struct Checkpoint {
+        size_t undoSize;
+        size_t outputSize;
+        Token anchor;
+    };
+
+    Checkpoint save() const {
+        return {undoLog.size(), pendingOutput.size(), pendingAnchor};
+    }
+
+    void restore(const Checkpoint& checkpoint) {
+        while (undoLog.size() > checkpoint.undoSize) {
+            UndoEntry& entry = undoLog.back();
+            if (entry.previous) {
+                env[entry.name] = std::move(*entry.previous);
+            } else {
+                env.erase(entry.name);
+            }
+            undoLog.pop_back();
+        }
+        pendingOutput.resize(checkpoint.outputSize);
+        pendingAnchor = checkpoint.anchor;
+    }
+
+    void bind(const std::string& name, Binding binding) {
+        auto it = env.find(name);
+        if (it == env.end()) {
+            undoLog.push_back({name, std::nullopt});
+            env.emplace(name, std::move(binding));
+        } else {
+            undoLog.push_back({name, std::move(it->second)});
+            it->second = std::move(binding);
+        }
+    }
+
+    static Token anchorOf(const ParsedStatement& stmt) {
+        if (!stmt.tokens.empty()) return stmt.tokens[0];
+        if (!stmt.children.empty()) return anchorOf(stmt.children[0]);
+        return {"", "", 0, 0};
+    }
+
+    // Expression evaluation
+    std::optional<Value> evaluateOperand(const Token& token) const {
+        try {
+            if (token.type == "integer_literal") {
+                long long literal = std::stoll(token.value);
+                return fitsInt32(literal) ? std::optional<Value>(literal) : std::nullopt;
+            }
+            if (token.type == "float_literal") return Value(std::stod(token.value));
+        } catch (const std::out_of_range&) {
+            return std::nullopt;
+        }
+        if (token.type == "string_literal" || token.type == "char_literal")
+            return Value(token.value.substr(1, token.value.size() - 2));
+        if (token.type == "keyword") {
+            if (token.value == "true") return Value(true);
+            if (token.value == "false") return Value(false);
+            if (token.value == "endl") return Value(std::string("\\n"));
+        }
+        if (token.type == "identifier") {
+            auto it = env.find(token.value);
+            if (it != env.end()) return it->second.value;
+        }
+        return std::nullopt;
+    }
+
+    static int precedence(const std::string& op) {
+        if (op == "*" || op == "/" || op == "%") return 4;
+        if (op == "+" || op == "-") return 3;
+        if (op == "<" || op == ">" || op == "<=" || op == ">=") return 2;
+        if (op == "==" || op == "!=") return 1;
+        return 0;
+    }
+
+    static std::optional<Value> applyOperator(const std::string& op, const Value& lhs, const Value& rhs) {
+        if (std::holds_alternative<std::string>(lhs) || std::holds_alternative<std::string>(rhs)) {
+            if (!std::holds_alternative<std::string>(lhs) || !std::holds_alternative<std::string>(rhs))
+                return std::nullopt;
+            if (op == "==") return Value(std::get<std::string>(lhs) == std::get<std::string>(rhs));
+            if (op == "!=") return Value(std::get<std::string>(lhs) != std::get<std::string>(rhs));
+            return std::nullopt;
+        }
+
+        if (std::holds_alternative<double>(lhs) || std::holds_alternative<double>(rhs)) {
+            double a = toDouble(lhs);
+            double b = toDouble(rhs);
+            std::optional<double> result;
+            if (op == "+") result = a + b;
+            if (op == "-") result = a - b;
+            if (op == "*") result = a * b;
+            if (op == "/" && b != 0.0) result = a / b;
+            // Infinities and NaNs have no literal form, so they stay residual
+            if (result) return std::isfinite(*result) ? std::optional<Value>(*result) : std::nullopt;
+            if (op == "<") return Value(a < b);
+            if (op == ">") return Value(a > b);
+            if (op == "<=") return Value(a <= b);
+            if (op == ">=") return Value(a >= b);
+            if (op == "==") return Value(a == b);
+            if (op == "!=") return Value(a != b);
+            return std::nullopt;
+        }
+
+        // Operands are 32-bit, so these cannot overflow long long; results that
+        // do not fit an intbox are left for the residual program
+        long long a = toInteger(lhs);
+        long long b = toInteger(rhs);
+        std::optional<long long> result;
+        if (op == "+") result = a + b;
+        if (op == "-") result = a - b;
+        if (op == "*") result = a * b;
+        // Division by zero is left for the residual program to hit at runtime
+        if ((op == "/" || op == "%") && b != 0) result = op == "/" ? a / b : a % b;
+        if (result) return fitsInt32(*result) ? std::optional<Value>(*result) : std::nullopt;
+        if (op == "<") return Value(a < b);
+        if (op == ">") return Value(a > b);
+        if (op == "<=") return Value(a <= b);
+        if (op == ">=") return Value(a >= b);
+        if (op == "==") return Value(a == b);
+        if (op == "!=") return Value(a != b);
+        return std::nullopt;
+    }
+
+    // intbox is emitted as dd
+    static bool fitsInt32(long long value) {
+        return value >= std::numeric_limits<int32_t>::min() && value <= std::numeric_limits<int32_t>::max();
+    }
+
+    // Whether a double still fits once truncated towards zero
+    static bool fitsInt32(double value) {
+        return value > static_cast<double>(std::numeric_limits<int32_t>::min()) - 1.0 &&
+               value < static_cast<double>(std::numeric_limits<int32_t>::max()) + 1.0;
+    }
+
+    static double toDouble(const Value& value) {
+        if (std::holds_alternative<double>(value)) return std::get<double>(value);
+        return static_cast<double>(toInteger(value));
+    }
+
+    static long long toInteger(const Value& value) {
+        if (std::holds_alternative<long long>(value)) return std::get<long long>(value);
+        if (std::holds_alternative<bool>(value)) return std::get<bool>(value) ? 1 : 0;
+        return static_cast<long long>(std::get<double>(value));
+    }
+
+    static std::optional<bool> truthiness(const Value& value) {
+        if (std::holds_alternative<std::string>(value)) return std::nullopt;
+        if (std::holds_alternative<double>(value)) return std::get<double>(value) != 0.0;
+        return toInteger(value) != 0;
+    }
+
+    // Operands and operators alternate, as guaranteed by Parser::parseExpression
+    std::optional<Value> evaluateExpression(const std::vector<Token>& tokens, size_t begin, size_t end) const {
+        if (begin >= end || (end - begin) % 2 == 0) return std::nullopt;
+
+        std::vector<Value> operands;
+        std::vector<std::string> operators;
+
+        auto reduce = [&]() {
+            Value rhs = std::move(operands.back());
+            operands.pop_back();
+            auto result = applyOperator(operators.back(), operands.back(), rhs);
+            operators.pop_back();
+            if (!result) return false;
+            operands.back() = std::move(*result);
+            return true;
+        };
+
+        for (size_t i = begin; i < end; ++i) {
+            if ((i - begin) % 2 == 0) {
+                auto operand = evaluateOperand(tokens[i]);
+                if (!operand) return std::nullopt;
+                operands.push_back(std::move(*operand));
+                continue;
+            }
+
+            int prec = precedence(tokens[i].value);
+            if (tokens[i].type != "operator" || prec == 0) return std::nullopt;
+            while (!operators.empty() && precedence(operators.back()) >= prec) {
+                if (!reduce()) return std::nullopt;
+            }
+            operators.push_back(tokens[i].value);
+        }
+
+        while (!operators.empty()) {
+            if (!reduce()) return std::nullopt;
+        }
+        return operands.back();
+    }
+
+    std::optional<bool> evaluateCondition(const ParsedStatement& stmt) const {
+        auto condition = evaluateExpression(stmt.tokens, 0, stmt.tokens.size());
+        if (!condition) return std::nullopt;
+        return truthiness(*condition);
+    }
+
+    static std::optional<Value> coerce(const std::string& varType, const Value& value) {
+        bool isString = std::holds_alternative<std::string>(value);
+        if (varType == "intbox") {
+            if (isString) return std::nullopt;
+            if (std::holds_alternative<double>(value) && !fitsInt32(std::get<double>(value))) return std::nullopt;
+            return Value(toInteger(value));
+        }
+        if (varType == "floatbox") return isString ? std::nullopt : std::optional<Value>(toDouble(value));
+        if (varType == "boolbox") {
+            auto truth = truthiness(value);
+            return truth ? std::optional<Value>(*truth) : std::nullopt;
+        }
+        if (varType == "stringbox" || varType == "charbox") return isString ? std::optional<Value>(value) : std::nullopt;
+        return std::nullopt;
+    }
+
+    // Values are kept in source escape form, so only bare quotes need escaping
+    static std::string escape(const std::string& text) {
+        std::string escaped;
+        for (size_t i = 0; i < text.size(); ++i) {
+            if (text[i] == '\\' && i + 1 < text.size()) {
+                escaped += text.substr(i++, 2);
+            } else if (text[i] == '"') {
+                escaped += "\\\"";
+            } else {
+                escaped += text[i];
+            }
+        }
+        return escaped;
+    }
+
+    static std::string render(const Value& value) {
+        if (std::holds_alternative<long long>(value)) return std::to_string(std::get<long long>(value));
+        if (std::holds_alternative<bool>(value)) return std::get<bool>(value) ? "1" : "0";
+        if (std::holds_alternative<std::string>(value)) return escape(std::get<std::string>(value));
+        return formatDouble(std::get<double>(value));
+    }
+
+    // Shortest text that reads back as exactly the same double. Used for both
+    // pre-rendered output and residual floatbox literals.
+    static std::string formatDouble(double value) {
+        char buffer[64];
+        auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        return std::string(buffer, end);
+    }
+
+    static Token makeLiteral(const std::string& varType, const Value& value, const Token& anchor) {
+        Token literal{"", "", anchor.line, anchor.column};
+        if (varType == "intbox") {
+            literal.type = "integer_literal";
+            literal.value = std::to_string(std::get<long long>(value));
+        } else if (varType == "floatbox") {
+            literal.type = "float_literal";
+            literal.value = formatDouble(std::get<double>(value));
+            // NASM only reads a constant with a period as floating point
+            if (literal.value.find('.') == std::string::npos) {
+                size_t exponent = literal.value.find('e');
+                literal.value.insert(exponent == std::string::npos ? literal.value.size() : exponent, ".0");
+            }
+        } else if (varType == "boolbox") {
+            literal.type = "keyword";
+            literal.value = std::get<bool>(value) ? "true" : "false";
+        } else if (varType == "charbox") {
+            literal.type = "char_literal";
+            literal.value = "'" + std::get<std::string>(value) + "'";
+        } else {
+            literal.type = "string_literal";
+            literal.value = "\"" + escape(std::get<std::string>(value)) + "\"";
+        }
+        return literal;
+    }
+
+    // Compile-time execution
+    bool evaluateDeclaration(const ParsedStatement& stmt) {
+        const std::string& varType = stmt.tokens[0].value;
+        std::optional<Value> value;
+
+        if (stmt.tokens.size() > 3) {
+            value = evaluateExpression(stmt.tokens, 3, stmt.tokens.size());
+        } else if (varType == "intbox") {
+            value = 0LL;
+        } else if (varType == "floatbox") {
+            value = 0.0;
+        } else if (varType == "boolbox") {
+            value = false;
+        } else if (varType == "stringbox") {
+            value = std::string();
+        }
+        if (!value) return false;
+
+        auto coerced = coerce(varType, *value);
+        if (!coerced) return false;
+        bind(stmt.tokens[1].value, {varType, std::move(coerced), false});
+        return true;
+    }
+
+    // Operands of an output statement are separated by '<<', which the
+    // tokenizer may also hand over as two adjacent '<' tokens.
+    bool evaluateOutput(const ParsedStatement& stmt) {
+        std::string rendered;
+        size_t begin = 1;
+        for (size_t i = 1; i <= stmt.tokens.size(); ++i) {
+            size_t width = 0;
+            if (i < stmt.tokens.size() && stmt.tokens[i].type == "operator") {
+                if (stmt.tokens[i].value == "<<") width = 1;
+                else if (stmt.tokens[i].value == "<" && i + 1 < stmt.tokens.size() &&
+                         stmt.tokens[i + 1].type == "operator" && stmt.tokens[i + 1].value == "<") width = 2;
+            }
+            if (i < stmt.tokens.size() && width == 0) continue;
+
+            auto value = evaluateExpression(stmt.tokens, begin, i);
+            if (!value) return false;
+            rendered += render(*value);
+            i += width == 0 ? 0 : width - 1;
+            begin = i + 1;
+        }
+
+        if (pendingOutput.empty()) pendingAnchor = anchorOf(stmt);
+        pendingOutput += rendered;
+        return true;
+    }
+
+    static std::span<const ParsedStatement> branchOf(const ParsedStatement& stmt, bool taken) {
+        return taken ? thenBranch(stmt) : elseBranch(stmt);
+    }
+
+    // Executes a statement entirely at compile time. Returns false, with env and
+    // pendingOutput left untouched, if it depends on runtime input or runs out of
+    // fuel. processBlock gives every statement it visits a fresh budget of fuelLimit
+    // steps: top-level statements and those spliced in from a known if branch.
+    bool evaluateStatic(const ParsedStatement& stmt) {
+        if (fuel <= 0) return false;
+        --fuel;
+
+        switch (stmt.type) {
+            case StatementType::VariableDeclaration:
+                return evaluateDeclaration(stmt);
+            case StatementType::Output:
+                return evaluateOutput(stmt);
+            case StatementType::IfStatement: {
+                auto taken = evaluateCondition(stmt);
+                if (!taken) return false;
+                Checkpoint checkpoint = save();
+                for (const auto& child : branchOf(stmt, *taken)) {
+                    if (!evaluateStatic(child)) {
+                        restore(checkpoint);
+                        return false;
+                    }
+                }
+                return true;
+            }
+            case StatementType::WhileLoop: {
+                auto taken = evaluateCondition(stmt);
+                if (!taken) return false;
+                Checkpoint checkpoint = save();
+                while (*taken) {
+                    if (fuel <= 0) {
+                        restore(checkpoint);
+                        return false;
+                    }
+                    --fuel;
+                    for (const auto& child : stmt.children) {
+                        if (!evaluateStatic(child)) {
+                            restore(checkpoint);
+                            return false;
+                        }
+                    }
+                    taken = evaluateCondition(stmt);
+                    if (!taken) {
+                        restore(checkpoint);
+                        return false;
+                    }
+                }
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    // Residual program construction
+    void flushOutput() {
+        if (pendingOutput.empty()) return;
+
+        ParsedStatement stmt;
+        stmt.type = StatementType::Output;
+        stmt.tokens.push_back({"operator", "<", pendingAnchor.line, pendingAnchor.column});
+        stmt.tokens.push_back({"string_literal", "\"" + pendingOutput + "\"", pendingAnchor.line, pendingAnchor.column});
+        residual.push_back(std::move(stmt));
+        pendingOutput.clear();
+    }
+
+    static void collectIdentifiers(const ParsedStatement& stmt, bool skipDeclaredName,
+                                   std::vector<std::string>& names, std::unordered_set<std::string>& seen) {
+        for (size_t i = 0; i < stmt.tokens.size(); ++i) {
+            if (skipDeclaredName && stmt.type == StatementType::VariableDeclaration && i == 1) continue;
+            if (stmt.tokens[i].type == "identifier" && seen.insert(stmt.tokens[i].value).second)
+                names.push_back(stmt.tokens[i].value);
+        }
+        for (const auto& child : stmt.children) {
+            collectIdentifiers(child, false, names, seen);
+        }
+    }
+
+    void markDynamic(const ParsedStatement& stmt) {
+        if (stmt.type == StatementType::VariableDeclaration) {
+            env[stmt.tokens[1].value] = {stmt.tokens[0].value, std::nullopt, false};
+        } else if (stmt.type == StatementType::Input) {
+            auto it = env.find(stmt.tokens[1].value);
+            if (it != env.end()) it->second.value.reset();
+        }
+        for (const auto& child : stmt.children) {
+            markDynamic(child);
+        }
+    }
+
+    // Keeps stmt for runtime, declaring every precomputed variable it touches first.
+    // Only variables the statement may assign lose their compile-time value.
+    void emitResidual(const ParsedStatement& stmt) {
+        flushOutput();
+
+        std::vector<std::string> names;
+        std::unordered_set<std::string> seen;
+        collectIdentifiers(stmt, true, names, seen);
+
+        Token anchor = anchorOf(stmt);
+        for (const auto& name : names) {
+            auto it = env.find(name);
+            if (it == env.end() || !it->second.value || it->second.declared) continue;
+
+            ParsedStatement decl;
+            decl.type = StatementType::VariableDeclaration;
+            decl.tokens.push_back({"keyword", it->second.type, anchor.line, anchor.column});
+            decl.tokens.push_back({"identifier", name, anchor.line, anchor.column});
+            decl.tokens.push_back({"operator", "=", anchor.line, anchor.column});
+            decl.tokens.push_back(makeLiteral(it->second.type, *it->second.value, anchor));
+            residual.push_back(std::move(decl));
+            it->second.declared = true;
+        }
+
+        residual.push_back(stmt);
+        markDynamic(stmt);
+    }
+
+    void processBlock(std::span<const ParsedStatement> stmts) {
+        for (const auto& stmt : stmts) {
+            // Per statement, so one endless loop cannot stop folding after it
+            fuel = fuelLimit;
+            bool folded = evaluateStatic(stmt);
+            undoLog.clear();
+            if (folded) {
+                foldedCount++;
+                continue;
+            }
+
+            // A known condition still lets us splice in just the branch taken
+            if (stmt.type == StatementType::IfStatement) {
+                auto taken = evaluateCondition(stmt);
+                if (taken) {
+                    processBlock(branchOf(stmt, *taken));
+                    continue;
+                }
+            }
+
+            emitResidual(stmt);
+        }
+    }
+
+public:
+    explicit Evaluator(long long stepLimit = 100000)
+        : pendingAnchor{"", "", 0, 0}, fuelLimit(stepLimit), fuel(stepLimit) {}
+
+    NodeProg evaluate(const NodeProg& prog) {
+        processBlock(prog.stmts);
+        flushOutput();
+
+        NodeProg residualProg;
+        residualProg.stmts = std::move(residual);
+        residual.clear();
+        return residualProg;
+    }
+
+    int getFoldedCount() const {
+        return foldedCount;
+    }
+};
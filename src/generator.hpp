@@ -2,43 +2,211 @@
 
 #include <fstream>
 #include <vector>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <stdexcept>
 #include <iostream>
 #include <sstream>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <algorithm>
 #include "parser.hpp"
+#include "profile.hpp"
 
 class Generator {
 private:
     std::ofstream outputFile;
+    std::ostringstream chunkBuffer;
+    std::ostream& output;
     std::unordered_map<std::string, std::string> symbolTable;
     int tempVarCounter = 0;
     int labelCounter = 0;
 
+    // Parallel code generation: chunk workers resolve variables declared in
+    // earlier chunks through the chunk index of each name's first declaration.
+    std::shared_ptr<const std::unordered_map<std::string, size_t>> firstDeclarations;
+    size_t chunkIndex = 0;
+    int probeBase = 0;
+    static constexpr size_t minChunkStatements = 4096;
+
+    // Instrumentation and profile feedback
+    bool instrument = false;
+    bool sampleCycles = false;
+    std::string profileOutputPath;
+    std::vector<ProfileRecord> probes;
+    std::shared_ptr<const Profile> profile;
+    static constexpr uint64_t hotLoopIterations = 1000;
+
+    // Labels and probes a statement consumes itself, excluding its
+    // children. Serial generation reserves exactly this much per statement and
+    // the parallel pre-pass sums it to find where each chunk's numbering starts.
+    struct StatementCost {
+        int labels = 0;
+        bool statementProbe = false;
+        bool loopProbe = false;
+    };
+
+    struct Reservation {
+        StatementCost cost;
+        int labelBase;
+    };
+
+    StatementCost costOf(const ParsedStatement& stmt) const {
+        StatementCost cost;
+        if (stmt.type == StatementType::IfStatement && !stmt.tokens.empty()) cost.labels = 3;
+        if (stmt.type == StatementType::WhileLoop) cost.labels = 2;
+        // Declarations only emit data, so they get no probe
+        if (instrument && !stmt.tokens.empty() && stmt.type != StatementType::VariableDeclaration) {
+            cost.statementProbe = true;
+            cost.loopProbe = stmt.type == StatementType::WhileLoop;
+        }
+        return cost;
+    }
+
+    void addCost(const ParsedStatement& stmt, int& labels, int& probeCount) const {
+        StatementCost cost = costOf(stmt);
+        labels += cost.labels;
+        probeCount += (cost.statementProbe ? 1 : 0) + (cost.loopProbe ? 1 : 0);
+        for (const auto& child : stmt.children) {
+            addCost(child, labels, probeCount);
+        }
+    }
+
+    Reservation reserve(const ParsedStatement& stmt) {
+        Reservation reservation{costOf(stmt), labelCounter};
+        labelCounter += reservation.cost.labels;
+        return reservation;
+    }
+
     std::string getTempVar() {
         return "temp" + std::to_string(tempVarCounter++);
     }
 
-    std::string getLabel(const std::string& base) {
-        return base + std::to_string(labelCounter++);
+    std::string getLabel(const Reservation& reservation, int index, const std::string& base) const {
+        if (index >= reservation.cost.labels) {
+            throw std::logic_error("Label used without being counted in costOf");
+        }
+        return base + std::to_string(reservation.labelBase + index);
     }
 
     void push(const std::string& reg) {
-        outputFile << "    push " << reg << "\n";
+        output << "    push " << reg << "\n";
     }
 
     void pop(const std::string& reg) {
-        outputFile << "    pop " << reg << "\n";
+        output << "    pop " << reg << "\n";
+    }
+
+    std::string probeField(int probe, size_t offset) const {
+        return "[prof_" + std::to_string(probe) + " + " + std::to_string(offset) + "]";
+    }
+
+    int addProbe(const Token& anchor, ProbeKind kind) {
+        probes.push_back({static_cast<uint64_t>(anchor.line), static_cast<uint64_t>(anchor.column),
+                          static_cast<uint64_t>(kind), 0, 0});
+        return probeBase + static_cast<int>(probes.size()) - 1;
+    }
+
+    void readTimestamp() {
+        output << "    rdtsc\n";
+        output << "    shl rdx, 32\n";
+        output << "    or rax, rdx\n";
+    }
+
+    int beginProbe(const ParsedStatement& stmt) {
+        if (!costOf(stmt).statementProbe) return -1;
+
+        int probe = addProbe(stmt.tokens[0], ProbeKind::Statement);
+        output << "section .text\n";
+        output << "    ; Profile line " << stmt.tokens[0].line << ", column " << stmt.tokens[0].column << "\n";
+        output << "    inc qword " << probeField(probe, Profile::countOffset) << "\n";
+        if (sampleCycles) {
+            push("rax");
+            push("rdx");
+            readTimestamp();
+            output << "    mov [prof_start_" << probe << "], rax\n";
+            pop("rdx");
+            pop("rax");
+        }
+        return probe;
     }
 
+    void endProbe(int probe) {
+        if (probe < 0 || !sampleCycles) return;
+
+        output << "section .text\n";
+        push("rax");
+        push("rdx");
+        readTimestamp();
+        output << "    sub rax, [prof_start_" << probe << "]\n";
+        output << "    add " << probeField(probe, Profile::cyclesOffset) << ", rax\n";
+        pop("rdx");
+        pop("rax");
+    }
+
+    // Execution count of a block, taken from its first probed statement
+    uint64_t profiledCount(std::span<const ParsedStatement> block) const {
+        for (const auto& child : block) {
+            if (child.type != StatementType::VariableDeclaration && !child.tokens.empty()) {
+                return profile->getCount(child.tokens[0].line, child.tokens[0].column, ProbeKind::Statement);
+            }
+        }
+        return 0;
+    }
+
+    std::string lookupSymbol(const std::string& name) const {
+        auto it = symbolTable.find(name);
+        if (it != symbolTable.end()) return it->second;
+        if (firstDeclarations) {
+            auto declared = firstDeclarations->find(name);
+            if (declared != firstDeclarations->end() && declared->second < chunkIndex) return "var_" + name;
+        }
+        return "";
+    }
+
+    static void recordDeclarations(const ParsedStatement& stmt, size_t chunk,
+                                   std::unordered_map<std::string, size_t>& declarations) {
+        if (stmt.type == StatementType::VariableDeclaration) {
+            declarations.try_emplace(stmt.tokens[1].value, chunk);
+        }
+        for (const auto& child : stmt.children) {
+            recordDeclarations(child, chunk, declarations);
+        }
+    }
+
+    // Chunk worker writing into its own buffer, numbering labels and probes
+    // from the bases the chunks before it would have reached serially
+    Generator(const Generator& parent, size_t chunk, int labelBase, int chunkProbeBase)
+        : output(chunkBuffer),
+          labelCounter(labelBase),
+          firstDeclarations(parent.firstDeclarations),
+          chunkIndex(chunk),
+          probeBase(chunkProbeBase),
+          instrument(parent.instrument),
+          sampleCycles(parent.sampleCycles),
+          profile(parent.profile) {}
+
 public:
-    Generator(const std::string& outputFilePath) {
+    Generator(const std::string& outputFilePath) : output(outputFile) {
         outputFile.open(outputFilePath);
         if (!outputFile.is_open()) {
             throw std::runtime_error("Failed to open output file: " + outputFilePath);
-    
-        outputFile << "section .data\n";
+        }
+
+        output << "section .data\n";
+    }
+
+    void enableInstrumentation(const std::string& profilePath, bool withCycles) {
+        instrument = true;
+        sampleCycles = withCycles;
+        profileOutputPath = profilePath;
+    }
+
+    void useProfile(const Profile& profileData) {
+        profile = std::make_shared<const Profile>(profileData);
     }
 
     ~Generator() {
@@ -47,8 +215,9 @@ public:
         }
     }
 
-    void generateCode(const std::vector<ParsedStatement>& parsedStatements) {
+    void generateCode(std::span<const ParsedStatement> parsedStatements) {
         for (const auto& stmt : parsedStatements) {
+            int probe = beginProbe(stmt);
             switch (stmt.type) {
                 case StatementType::VariableDeclaration:
                     generateVariableDeclaration(stmt);
@@ -71,9 +240,79 @@ public:
                 default:
                     throw std::runtime_error("Invalid statement type");
             }
+            endProbe(probe);
         }
     }
 
+    // Splits the top-level statements into chunks generated on threadCount
+    // threads. Output is byte-identical to generateCode. Returns the number of
+    // chunks used, 1 when the program is too small to split.
+    size_t generateCodeParallel(const std::vector<ParsedStatement>& parsedStatements, unsigned threadCount) {
+        size_t chunkCount = std::min<size_t>(static_cast<size_t>(threadCount) * 4,
+                                             parsedStatements.size() / minChunkStatements);
+        if (threadCount <= 1 || chunkCount <= 1) {
+            generateCode(parsedStatements);
+            return 1;
+        }
+
+        std::vector<size_t> chunkStarts(chunkCount + 1);
+        for (size_t chunk = 0; chunk <= chunkCount; ++chunk) {
+            chunkStarts[chunk] = parsedStatements.size() * chunk / chunkCount;
+        }
+
+        auto declarations = std::make_shared<std::unordered_map<std::string, size_t>>();
+        for (const auto& [name, asmVar] : symbolTable) {
+            declarations->try_emplace(name, 0);
+        }
+
+        std::vector<std::unique_ptr<Generator>> workers;
+        int labelBase = labelCounter;
+        int chunkProbeBase = probeBase + static_cast<int>(probes.size());
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            workers.push_back(std::unique_ptr<Generator>(
+                new Generator(*this, chunk + 1, labelBase, chunkProbeBase)));
+            for (size_t i = chunkStarts[chunk]; i < chunkStarts[chunk + 1]; ++i) {
+                addCost(parsedStatements[i], labelBase, chunkProbeBase);
+                recordDeclarations(parsedStatements[i], chunk + 1, *declarations);
+            }
+        }
+        for (auto& worker : workers) {
+            worker->firstDeclarations = declarations;
+        }
+
+        std::atomic<size_t> nextChunk{0};
+        std::vector<std::exception_ptr> errors(chunkCount);
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < std::min<size_t>(threadCount, chunkCount); ++t) {
+            threads.emplace_back([&]() {
+                for (size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++) {
+                    try {
+                        workers[chunk]->generateCode(std::span<const ParsedStatement>(parsedStatements).subspan(
+                            chunkStarts[chunk], chunkStarts[chunk + 1] - chunkStarts[chunk]));
+                    } catch (...) {
+                        errors[chunk] = std::current_exception();
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // Concatenate in chunk order, stopping where the serial walk would have thrown
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            output << workers[chunk]->chunkBuffer.str();
+            if (errors[chunk]) std::rethrow_exception(errors[chunk]);
+
+            labelCounter = workers[chunk]->labelCounter;
+            probes.insert(probes.end(), workers[chunk]->probes.begin(), workers[chunk]->probes.end());
+            for (auto& [name, asmVar] : workers[chunk]->symbolTable) {
+                symbolTable[name] = asmVar;
+            }
+        }
+        return chunkCount;
+    }
+
     void generateVariableDeclaration(const ParsedStatement& stmt) {
         std::string varType = stmt.tokens[0].value;
         std::string varName = stmt.tokens[1].value;
@@ -81,36 +320,36 @@ public:
         symbolTable[varName] = asmVar;
 
         if (varType == "intbox") {
-            outputFile << asmVar << " dd " << (stmt.tokens.size() > 3 ? stmt.tokens[3].value : "0") << "\n";
+            output << asmVar << " dd " << (stmt.tokens.size() > 3 ? stmt.tokens[3].value : "0") << "\n";
         } else if (varType == "floatbox") {
-            outputFile << asmVar << " dq " << (stmt.tokens.size() > 3 ? stmt.tokens[3].value : "0.0") << "\n";
+            output << asmVar << " dq " << (stmt.tokens.size() > 3 ? stmt.tokens[3].value : "0.0") << "\n";
         } else if (varType == "charbox") {
-            outputFile << asmVar << " db " << (stmt.tokens.size() > 3 ? "'" + stmt.tokens[3].value + "'" : "0") << "\n";
+            output << asmVar << " db " << (stmt.tokens.size() > 3 ? "'" + stmt.tokens[3].value + "'" : "0") << "\n";
         } else if (varType == "stringbox") {
-            outputFile << asmVar << " db " << (stmt.tokens.size() > 3 ? "\"" + stmt.tokens[3].value + "\"" : "\"\"") << ", 0\n";
+            output << asmVar << " db " << (stmt.tokens.size() > 3 ? "\"" + stmt.tokens[3].value + "\"" : "\"\"") << ", 0\n";
         } else if (varType == "boolbox") {
-            outputFile << asmVar << " db " << (stmt.tokens.size() > 3 ? (stmt.tokens[3].value == "true" ? "1" : "0") : "0") << "\n";
+            output << asmVar << " db " << (stmt.tokens.size() > 3 ? (stmt.tokens[3].value == "true" ? "1" : "0") : "0") << "\n";
         } else {
             throw std::runtime_error("Unsupported variable type: " + varType);
         }
     }
 
     void generateOutput(const ParsedStatement& stmt) {
-        outputFile << "section .text\n";
-        outputFile << "    ; Output logic\n";
+        output << "section .text\n";
+        output << "    ; Output logic\n";
         for (const auto& token : stmt.tokens) {
             if (token.type == "string_literal") {
-                outputFile << "    ; Print string literal\n";
-                outputFile << "    mov rdi, " << token.value << "\n";
-                outputFile << "    ; Add your OS-specific syscall for printing here\n";
+                output << "    ; Print string literal\n";
+                output << "    mov rdi, " << token.value << "\n";
+                output << "    ; Add your OS-specific syscall for printing here\n";
             } else if (token.type == "identifier") {
-                outputFile << "    ; Print identifier\n";
-                outputFile << "    mov rax, " << symbolTable[token.value] << "\n";
-                outputFile << "    ; Add your OS-specific syscall for printing here\n";
+                output << "    ; Print identifier\n";
+                output << "    mov rax, " << lookupSymbol(token.value) << "\n";
+                output << "    ; Add your OS-specific syscall for printing here\n";
             } else if (token.type == "keyword" && token.value == "endl") {
-                outputFile << "    ; Print newline\n";
-                outputFile << "    mov rdi, '\\n'\n";
-                outputFile << "    ; Add your OS-specific syscall for printing here\n";
+                output << "    ; Print newline\n";
+                output << "    mov rdi, '\\n'\n";
+                output << "    ; Add your OS-specific syscall for printing here\n";
             }
         }
     }
@@ -120,93 +359,183 @@ public:
     }
 
     void generateIfStatement(const ParsedStatement& stmt) {
-        std::string trueLabel = getLabel("true_branch");
-        std::string falseLabel = getLabel("false_branch");
-        std::string endLabel = getLabel("end_if");
-
-        outputFile << "section .text\n";
-        outputFile << "    ; If statement\n";
-
-        const auto& condition = stmt.tokens;
-        if (condition.size() == 3) {
-            outputFile << "    cmp " << symbolTable[condition[0].value] << ", " << condition[2].value << "\n";
-            if (condition[1].value == "==") {
-                outputFile << "    je " << trueLabel << "\n";
-            } else if (condition[1].value == "!=") {
-                outputFile << "    jne " << trueLabel << "\n";
-            } else if (condition[1].value == "<") {
-                outputFile << "    jl " << trueLabel << "\n";
-            } else if (condition[1].value == "<=") {
-                outputFile << "    jle " << trueLabel << "\n";
-            } else if (condition[1].value == ">") {
-                outputFile << "    jg " << trueLabel << "\n";
-            } else if (condition[1].value == ">=") {
-                outputFile << "    jge " << trueLabel << "\n";
-            }
-        }
+        Reservation reservation = reserve(stmt);
+        std::string trueLabel = getLabel(reservation, 0, "true_branch");
+        std::string falseLabel = getLabel(reservation, 1, "false_branch");
+        std::string endLabel = getLabel(reservation, 2, "end_if");
 
-        outputFile << "    jmp " << falseLabel << "\n";
-        outputFile << trueLabel << ":\n";
+        output << "section .text\n";
+        output << "    ; If statement\n";
 
-        // Generate code for true branch
-        for (const auto& child : stmt.children) {
-            generateCode({child});
-        }
+        generateConditionJump(stmt.tokens, trueLabel, false);
+
+        std::span<const ParsedStatement> trueBranch = thenBranch(stmt);
+        std::span<const ParsedStatement> falseBranch = elseBranch(stmt);
+
+        if (profile && !profile->empty() && profiledCount(falseBranch) > profiledCount(trueBranch)) {
+            // Lay the hot false branch out as the fall-through path
+            output << "    ; Profile: false branch is hot\n";
+            output << falseLabel << ":\n";
+            generateCode(falseBranch);
+            output << "    jmp " << endLabel << "\n";
+            output << trueLabel << ":\n";
+            generateCode(trueBranch);
+        } else {
+            output << "    jmp " << falseLabel << "\n";
+            output << trueLabel << ":\n";
+
+            // Generate code for true branch
+            generateCode(trueBranch);
 
-        outputFile << "    jmp " << endLabel << "\n";
-        outputFile << falseLabel << ":\n";
+            output << "    jmp " << endLabel << "\n";
+            output << falseLabel << ":\n";
 
-        // Generate code for false branch
-        if (stmt.children.size() > 1) {
-            generateCode({stmt.children[1]});
+            // Generate code for false branch
+            generateCode(falseBranch);
         }
 
-        outputFile << endLabel << ":\n";
+        output << endLabel << ":\n";
     }
 
     void generateWhileLoop(const ParsedStatement& stmt) {
-        std::string startLabel = getLabel("start_loop");
-        std::string endLabel = getLabel("end_loop");
-
-        outputFile << "section .text\n";
-        outputFile << "    ; While loop\n";
-        outputFile << startLabel << ":\n";
-
-        const auto& condition = stmt.tokens;
-        if (condition.size() == 3) {
-            outputFile << "    cmp " << symbolTable[condition[0].value] << ", " << condition[2].value << "\n";
-            if (condition[1].value == "==") {
-                outputFile << "    je " << startLabel << "\n";
-            } else if (condition[1].value == "!=") {
-                outputFile << "    jne " << startLabel << "\n";
-            } else if (condition[1].value == "<") {
-                outputFile << "    jl " << startLabel << "\n";
-            } else if (condition[1].value == "<=") {
-                outputFile << "    jle " << startLabel << "\n";
-            } else if (condition[1].value == ">") {
-                outputFile << "    jg " << startLabel << "\n";
-            } else if (condition[1].value == ">=") {
-                outputFile << "    jge " << startLabel << "\n";
-            }
+        Reservation reservation = reserve(stmt);
+        std::string startLabel = getLabel(reservation, 0, "start_loop");
+        std::string endLabel = getLabel(reservation, 1, "end_loop");
+
+        output << "section .text\n";
+        output << "    ; While loop\n";
+        if (!stmt.tokens.empty() &&
+            profile && profile->getCount(stmt.tokens[0].line, stmt.tokens[0].column, ProbeKind::Loop) >= hotLoopIterations) {
+            output << "    ; Profile: hot loop\n";
+            output << "    align 16\n";
         }
-        for (const auto& child : stmt.children) {
-            generateCode({child});
+        output << startLabel << ":\n";
+
+        // Leave the loop as soon as the condition fails
+        generateConditionJump(stmt.tokens, endLabel, true);
+        if (reservation.cost.loopProbe) {
+            int probe = addProbe(stmt.tokens[0], ProbeKind::Loop);
+            output << "    inc qword " << probeField(probe, Profile::countOffset) << "\n";
+        }
+        generateCode(stmt.children);
+        output << "    jmp " << startLabel << "\n";
+        output << endLabel << ":\n";
+    }
+
+    // Comparison operand: the dword an intbox variable lives in, or an immediate
+    std::string conditionOperand(const Token& token) const {
+        if (token.type == "identifier") return "dword [" + lookupSymbol(token.value) + "]";
+        if (token.type == "keyword") return token.value == "true" ? "1" : "0";
+        return token.value;
+    }
+
+    // Jumps to target when the condition holds, or when it fails if negate is set.
+    // Supports a single operand or a single comparison; other conditions emit no jump.
+    void generateConditionJump(const std::vector<Token>& condition, const std::string& target, bool negate) {
+        static const std::unordered_map<std::string, std::pair<std::string, std::string>> jumps = {
+            {"==", {"je", "jne"}}, {"!=", {"jne", "je"}}, {"<", {"jl", "jge"}},
+            {"<=", {"jle", "jg"}}, {">", {"jg", "jle"}}, {">=", {"jge", "jl"}}
+        };
+
+        std::string rhs = "0";
+        std::string op = "!=";
+        if (condition.size() == 3 && jumps.count(condition[1].value)) {
+            rhs = conditionOperand(condition[2]);
+            op = condition[1].value;
+        } else if (condition.size() != 1) {
+            return;
         }
-        outputFile << "    jmp " << startLabel << "\n";
-        outputFile << endLabel << ":\n";
+
+        const auto& jump = jumps.at(op);
+        output << "    mov eax, " << conditionOperand(condition[0]) << "\n";
+        output << "    cmp eax, " << rhs << "\n";
+        output << "    " << (negate ? jump.second : jump.first) << " " << target << "\n";
     }
 
     void generateExpression(const ParsedStatement& stmt) {
-        outputFile << "section .text\n";
-        outputFile << "    ; Expression logic: ";
+        output << "section .text\n";
+        output << "    ; Expression logic: ";
         for (const auto& token : stmt.tokens) {
-            outputFile << token.value << " ";
+            output << token.value << " ";
         }
-        outputFile << "\n";
+        output << "\n";
     }
 
     void finalize() {
-        outputFile << "    ; Finalize assembly\n";
+        output << "section .text\n";
+        if (instrument) {
+            output << "    ; Write profile before exit\n";
+            output << "    call prof_dump\n";
+        }
+        generateExit();
+
+        output << "    ; Finalize assembly\n";
+
+        if (instrument) {
+            finalizeInstrumentation();
+        }
         outputFile.close();
     }
+
+    // OS-specific sequences live here and target Linux x86-64 syscalls
+    void generateExit() {
+        output << "    ; Exit with status 0 (Linux x86-64)\n";
+        output << "    mov rax, 60\n";
+        output << "    xor rdi, rdi\n";
+        output << "    syscall\n";
+    }
+
+    // Writes prof_table_size bytes from prof_table to the file named by prof_path
+    void generateProfileWrite() {
+        output << "    ; Write profile file (Linux x86-64)\n";
+        output << "    mov rax, 2\n";
+        output << "    lea rdi, [prof_path]\n";
+        output << "    mov rsi, 0x241\n"; // O_WRONLY | O_CREAT | O_TRUNC
+        output << "    mov rdx, 420\n";   // 0644
+        output << "    syscall\n";
+        output << "    test rax, rax\n";
+        output << "    js prof_dump_done\n";
+        output << "    mov rdi, rax\n";
+        output << "    lea rsi, [prof_table]\n";
+        output << "    mov rdx, prof_table_size\n";
+        output << "prof_dump_write:\n";
+        output << "    test rdx, rdx\n";
+        output << "    jz prof_dump_close\n";
+        output << "    mov rax, 1\n";
+        output << "    syscall\n";
+        output << "    test rax, rax\n";
+        output << "    jle prof_dump_close\n";
+        output << "    add rsi, rax\n";
+        output << "    sub rdx, rax\n";
+        output << "    jmp prof_dump_write\n";
+        output << "prof_dump_close:\n";
+        output << "    mov rax, 3\n";
+        output << "    syscall\n";
+        output << "prof_dump_done:\n";
+    }
+
+    // Emits the probe table and the routine that dumps it verbatim as the profile
+    // file. The routine follows the exit syscall, so it only runs when called.
+    void finalizeInstrumentation() {
+        output << "prof_dump:\n";
+        generateProfileWrite();
+        output << "    ret\n";
+
+        output << "section .data\n";
+        output << "prof_path db \"" << profileOutputPath << "\", 0\n";
+        output << "prof_table:\n";
+        for (size_t i = 0; i < probes.size(); ++i) {
+            output << "prof_" << i << " dq " << probes[i].line << ", " << probes[i].column << ", "
+                   << probes[i].kind << ", 0, 0\n";
+        }
+        output << "prof_table_end:\n";
+        output << "prof_table_size equ prof_table_end - prof_table\n";
+        if (sampleCycles) {
+            for (size_t i = 0; i < probes.size(); ++i) {
+                if (probes[i].kind == static_cast<uint64_t>(ProbeKind::Statement)) {
+                    output << "prof_start_" << i << " dq 0\n";
+                }
+            }
+        }
+    }
 };
@@ -1,19 +1,76 @@
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 #include "tokenstore.hpp"
 #include "parser.hpp"
+#include "evaluator.hpp"
 #include "generator.hpp"
+#include "profile.hpp"
 
 int main(int argc, char* argv[]) {
     std::cout << "Compiler started\n";
 
+    const char* usage = "Usage: kat_compiler [--instrument | --instrument-cycles] [--use-profile <file.prof>] [--jobs <n>] [--time-codegen] <file.kat>\n"
+                        "       kat_compiler --report <file.prof>\n";
     if (argc < 2) {
-        std::cerr << "Usage: kat_compiler <file.kat>\n";
+        std::cerr << usage;
         return 1;
     }
 
-    std::filesystem::path katFile = argv[1];
+    std::filesystem::path katFile;
+    bool instrument = false;
+    bool sampleCycles = false;
+    bool timeCodegen = false;
+    std::string profilePath;
+    unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--report" || arg == "--use-profile" || arg == "--jobs") {
+            if (i + 1 >= argc) {
+                std::cerr << usage;
+                return 1;
+            }
+            if (arg == "--use-profile") {
+                profilePath = argv[++i];
+                continue;
+            }
+            if (arg == "--jobs") {
+                const char* value = argv[++i];
+                const char* valueEnd = value + std::strlen(value);
+                auto [end, error] = std::from_chars(value, valueEnd, jobs);
+                if (error != std::errc() || end != valueEnd || jobs == 0) {
+                    std::cerr << "Error: --jobs expects a positive integer, got '" << value << "'\n" << usage;
+                    return 1;
+                }
+                continue;
+            }
+            try {
+                Profile profile;
+                profile.load(argv[i + 1]);
+                profile.printReport();
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << "\n";
+                return 1;
+            }
+            return 0;
+        } else if (arg == "--instrument") {
+            instrument = true;
+        } else if (arg == "--instrument-cycles") {
+            instrument = true;
+            sampleCycles = true;
+        } else if (arg == "--time-codegen") {
+            timeCodegen = true;
+        } else {
+            katFile = arg;
+        }
+    }
+
     if (katFile.extension() != ".kat") {
         std::cerr << "Error: Input file must have a .kat extension.\n";
         return 1;
@@ -40,9 +97,29 @@ int main(int argc, char* argv[]) {
         parser.parse();
 
         NodeProg parsedProgram = parser.getParsedProgram();
+
+        Evaluator evaluator;
+        NodeProg residualProgram = evaluator.evaluate(parsedProgram);
+        std::cout << "Partial evaluation folded " << evaluator.getFoldedCount() << " statement(s).\n";
+
         Generator codeGen("program.asm");
+        if (instrument) {
+            codeGen.enableInstrumentation("program.prof", sampleCycles);
+        }
+        if (!profilePath.empty()) {
+            Profile profile;
+            profile.load(profilePath);
+            codeGen.useProfile(profile);
+        }
 
-        codeGen.generateCode(parsedProgram.stmts);
+        auto codegenStart = std::chrono::steady_clock::now();
+        size_t chunks = codeGen.generateCodeParallel(residualProgram.stmts, jobs);
+        auto codegenTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - codegenStart);
+        if (timeCodegen) {
+            std::cout << "Code generation used " << chunks << " chunk(s) on " << jobs << " thread(s) in "
+                      << codegenTime.count() << " ms.\n";
+        }
         codeGen.finalize();
 
         std::cout << "Assembly code generated successfully.\n";
@@ -6,6 +6,7 @@
 #include <stdexcept>
 #include <optional>
 #include <variant>
+#include <span>
 #include "tokenstore.hpp"
 
 enum class StatementType {
@@ -24,6 +25,21 @@ struct ParsedStatement {
     std::vector<ParsedStatement> children;
 };
 
+// The parser stores an if's else block as a trailing condition-less IfStatement child
+inline bool hasElseBranch(const ParsedStatement& stmt) {
+    return !stmt.children.empty() && stmt.children.back().type == StatementType::IfStatement &&
+           stmt.children.back().tokens.empty();
+}
+
+inline std::span<const ParsedStatement> thenBranch(const ParsedStatement& stmt) {
+    return {stmt.children.data(), stmt.children.size() - (hasElseBranch(stmt) ? 1 : 0)};
+}
+
+inline std::span<const ParsedStatement> elseBranch(const ParsedStatement& stmt) {
+    if (!hasElseBranch(stmt)) return {};
+    return stmt.children.back().children;
+}
+
 struct NodeProg {
     std::vector<ParsedStatement> stmts;
 };
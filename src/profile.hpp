@@ -0,0 +1,107 @@
+#pragma once
+
+#include <fstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <tuple>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <iostream>
+
+enum class ProbeKind : uint64_t {
+    Statement = 0,
+    Loop = 1
+};
+
+// One record per probe, laid out exactly like the prof_table an
+// instrumented program dumps at exit: five little-endian 64-bit words.
+struct ProfileRecord {
+    uint64_t line;
+    uint64_t column;
+    uint64_t kind;
+    uint64_t count;
+    uint64_t cycles;
+};
+
+class Profile {
+private:
+    std::vector<ProfileRecord> records;
+    std::map<std::tuple<uint64_t, uint64_t, uint64_t>, uint64_t> counts; // (line, column, kind) -> count
+
+public:
+    static constexpr size_t recordSize = sizeof(ProfileRecord);
+    static constexpr size_t countOffset = offsetof(ProfileRecord, count);
+    static constexpr size_t cyclesOffset = offsetof(ProfileRecord, cycles);
+
+    void load(const std::string& profilePath) {
+        std::ifstream file(profilePath, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open profile file: " + profilePath);
+        }
+
+        std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (data.size() % recordSize != 0) {
+            throw std::runtime_error("Malformed profile file: " + profilePath);
+        }
+
+        records.resize(data.size() / recordSize);
+        std::copy(data.begin(), data.end(), reinterpret_cast<char*>(records.data()));
+
+        counts.clear();
+        for (const auto& record : records) {
+            if (!counts.try_emplace({record.line, record.column, record.kind}, record.count).second) {
+                throw std::runtime_error("Duplicate probe for line " + std::to_string(record.line) + ", column " +
+                                         std::to_string(record.column) + " in profile file: " + profilePath);
+            }
+        }
+    }
+
+    uint64_t getCount(int line, int column, ProbeKind kind) const {
+        auto it = counts.find({static_cast<uint64_t>(line), static_cast<uint64_t>(column), static_cast<uint64_t>(kind)});
+        return it != counts.end() ? it->second : 0;
+    }
+
+    bool empty() const {
+        return records.empty();
+    }
+
+    // Prints source lines ordered by cycles when sampled, execution count otherwise
+    void printReport(size_t limit = 10) const {
+        struct LineTotals {
+            uint64_t count = 0;
+            uint64_t loopIterations = 0;
+            uint64_t cycles = 0;
+        };
+
+        std::map<uint64_t, LineTotals> totals;
+        bool hasCycles = false;
+        for (const auto& record : records) {
+            auto& line = totals[record.line];
+            if (record.kind == static_cast<uint64_t>(ProbeKind::Loop)) {
+                line.loopIterations += record.count;
+            } else {
+                line.count += record.count;
+                line.cycles += record.cycles;
+            }
+            hasCycles = hasCycles || record.cycles != 0;
+        }
+
+        std::vector<std::pair<uint64_t, LineTotals>> hottest(totals.begin(), totals.end());
+        std::stable_sort(hottest.begin(), hottest.end(), [hasCycles](const auto& a, const auto& b) {
+            if (hasCycles) return a.second.cycles > b.second.cycles;
+            return a.second.count + a.second.loopIterations > b.second.count + b.second.loopIterations;
+        });
+        if (hottest.size() > limit) hottest.resize(limit);
+
+        std::cout << "Hottest source lines:\n";
+        for (const auto& [line, lineTotals] : hottest) {
+            std::cout << "  line " << line << ": " << lineTotals.count << " executions";
+            if (lineTotals.loopIterations != 0) std::cout << ", " << lineTotals.loopIterations << " loop iterations";
+            if (hasCycles) std::cout << ", " << lineTotals.cycles << " cycles";
+            std::cout << "\n";
+        }
+    }
+};
@@ -38,8 +38,10 @@ private:
     const std::regex stringLiteralRegex = std::regex(R"("(\\.|[^"\\])*")");
     const std::regex charLiteralRegex = std::regex(R"('(\\.|[^'\\])')");
 
+    // Every token value is its exact lexeme, so the next token starts value.size() columns later
     void addToken(const std::string& type, const std::string& value) {
         tokens.push_back({type, value, lineNumber, columnNumber});
+        columnNumber += static_cast<int>(value.size());
     }
 
     void skipComments(const std::string& source, size_t& pos) {
@@ -47,6 +49,7 @@ private:
             while (pos < source.size() && source[pos] != '\n') pos++;
         } else if (source.substr(pos, 2) == "/*") {
             pos += 2; // Skip "/*"
+            columnNumber += 2;
             while (pos < source.size() && source.substr(pos, 2) != "*/") {
                 if (source[pos] == '\n') {
                     lineNumber++;
@@ -61,6 +64,7 @@ private:
                                          std::to_string(lineNumber));
             }
             pos += 2; // Skip "*/"
+            columnNumber += 2;
         }
     }
 
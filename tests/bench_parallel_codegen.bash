@@ -0,0 +1,28 @@
+#!/usr/bin/env bash
+# Reports code generation time per thread count on a large generated program.
+# Usage: bench_parallel_codegen.bash <kat_compiler> [statements] [thread counts...]
+set -euo pipefail
+
+compiler=$(realpath "$1")
+statements=${2:-200000}
+shift $(( $# > 1 ? 2 : 1 ))
+threads=("$@")
+if [ ${#threads[@]} -eq 0 ]; then
+    threads=(1 2 4 8)
+fi
+
+script_dir=$(dirname "$(realpath "$0")")
+work_dir=$(mktemp -d)
+trap 'rm -rf "$work_dir"' EXIT
+
+cmake -DKAT_FILE="$work_dir/large.kat" -DSTATEMENTS="$statements" -P "$script_dir/generate_large_kat.cmake"
+cd "$work_dir"
+
+echo "statements: $statements, cores: $(nproc)"
+printf "%8s %8s %10s\n" threads chunks codegen_ms
+for jobs in "${threads[@]}"; do
+    line=$("$compiler" --jobs "$jobs" --time-codegen large.kat | grep "Code generation used")
+    chunks=$(echo "$line" | sed -E 's/.*used ([0-9]+) chunk.*/\1/')
+    ms=$(echo "$line" | sed -E 's/.* in ([0-9]+) ms.*/\1/')
+    printf "%8s %8s %10s\n" "$jobs" "$chunks" "$ms"
+done
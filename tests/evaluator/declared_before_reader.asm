@@ -0,0 +1,29 @@
+section .data
+section .text
+    ; Output logic
+    ; Print string literal
+    mov rdi, "Enter: "
+    ; Add your OS-specific syscall for printing here
+var_y dd 0
+var_limit dd 42
+section .text
+    ; If statement
+    mov eax, dword [var_y]
+    cmp eax, dword [var_limit]
+    jg true_branch0
+    jmp false_branch1
+true_branch0:
+section .text
+    ; Output logic
+    ; Print string literal
+    mov rdi, "big"
+    ; Add your OS-specific syscall for printing here
+    jmp end_if2
+false_branch1:
+end_if2:
+section .text
+    ; Exit with status 0 (Linux x86-64)
+    mov rax, 60
+    xor rdi, rdi
+    syscall
+    ; Finalize assembly
@@ -0,0 +1,25 @@
+section .data
+section .text
+    ; While loop
+start_loop0:
+    mov eax, 1
+    cmp eax, 1
+    jne end_loop1
+section .text
+    ; Output logic
+    ; Print string literal
+    mov rdi, "spin"
+    ; Add your OS-specific syscall for printing here
+    jmp start_loop0
+end_loop1:
+section .text
+    ; Output logic
+    ; Print string literal
+    mov rdi, "after"
+    ; Add your OS-specific syscall for printing here
+section .text
+    ; Exit with status 0 (Linux x86-64)
+    mov rax, 60
+    xor rdi, rdi
+    syscall
+    ; Finalize assembly
@@ -0,0 +1,13 @@
+section .data
+var_big dd 2000000000
+section .text
+    ; Output logic
+    ; Print identifier
+    mov rax, var_big
+    ; Add your OS-specific syscall for printing here
+section .text
+    ; Exit with status 0 (Linux x86-64)
+    mov rax, 60
+    xor rdi, rdi
+    syscall
+    ; Finalize assembly
@@ -0,0 +1,12 @@
+section .data
+section .text
+    ; Output logic
+    ; Print string literal
+    mov rdi, "x is 42\n"
+    ; Add your OS-specific syscall for printing here
+section .text
+    ; Exit with status 0 (Linux x86-64)
+    mov rax, 60
+    xor rdi, rdi
+    syscall
+    ; Finalize assembly
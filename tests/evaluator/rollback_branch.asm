@@ -0,0 +1,18 @@
+section .data
+section .text
+    ; Output logic
+    ; Print string literal
+    mov rdi, "inside"
+    ; Add your OS-specific syscall for printing here
+var_y dd 0
+section .text
+    ; Output logic
+    ; Print string literal
+    mov rdi, "55"
+    ; Add your OS-specific syscall for printing here
+section .text
+    ; Exit with status 0 (Linux x86-64)
+    mov rax, 60
+    xor rdi, rdi
+    syscall
+    ; Finalize assembly
@@ -0,0 +1,23 @@
+section .data
+var_x dd 0
+var_y dd 0
+section .text
+    ; While loop
+start_loop0:
+    mov eax, dword [var_x]
+    cmp eax, 3
+    jge end_loop1
+section .text
+    ; Output logic
+    ; Print string literal
+    mov rdi, "before"
+    ; Add your OS-specific syscall for printing here
+var_x dd x
+    jmp start_loop0
+end_loop1:
+section .text
+    ; Exit with status 0 (Linux x86-64)
+    mov rax, 60
+    xor rdi, rdi
+    syscall
+    ; Finalize assembly
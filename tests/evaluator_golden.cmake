@@ -0,0 +1,21 @@
+# Compiles a Kat program and checks the emitted program.asm against a golden file.
+# Usage: cmake -DKAT_COMPILER=<path> -DKAT_FILE=<file.kat> -DEXPECTED=<file.asm>
+#              -DWORK_DIR=<dir> -P evaluator_golden.cmake
+
+file(MAKE_DIRECTORY ${WORK_DIR})
+execute_process(
+    COMMAND ${KAT_COMPILER} ${KAT_FILE}
+    WORKING_DIRECTORY ${WORK_DIR}
+    OUTPUT_QUIET
+    ERROR_VARIABLE error
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "kat_compiler ${KAT_FILE} failed:\n${error}")
+endif()
+
+file(READ ${WORK_DIR}/program.asm output)
+file(READ ${EXPECTED} expected)
+if(NOT output STREQUAL expected)
+    message(FATAL_ERROR "${KAT_FILE} produced:\n${output}\nexpected:\n${expected}")
+endif()
@@ -0,0 +1,34 @@
+# Writes a large .kat program whose statements depend on runtime input, so the
+# partial evaluator leaves them all to the Generator.
+# Usage: cmake -DKAT_FILE=<file.kat> -DSTATEMENTS=<n> -P generate_large_kat.cmake
+
+if(NOT KAT_FILE OR NOT STATEMENTS)
+    message(FATAL_ERROR "KAT_FILE and STATEMENTS must be set")
+endif()
+
+file(WRITE ${KAT_FILE} "start {\n    intbox y = 1;\n    in >> y;\n")
+
+set(batch "")
+math(EXPR last "${STATEMENTS} - 1")
+foreach(i RANGE ${last})
+    math(EXPR kind "${i} % 4")
+    math(EXPR var "${i} % 50")
+    math(EXPR bound "${i} % 7")
+    if(kind EQUAL 0)
+        string(APPEND batch "    intbox z${var} = y;\n")
+    elseif(kind EQUAL 1)
+        string(APPEND batch "    if (y > ${bound}) { out << z${var}; } else { out << \"small\"; }\n")
+    elseif(kind EQUAL 2)
+        string(APPEND batch "    while (y < ${bound}) { out << y; if (y == 2) { out << z${var}; } }\n")
+    else()
+        string(APPEND batch "    out << y;\n")
+    endif()
+
+    math(EXPR flush "${i} % 1000")
+    if(flush EQUAL 999)
+        file(APPEND ${KAT_FILE} "${batch}")
+        set(batch "")
+    endif()
+endforeach()
+
+file(APPEND ${KAT_FILE} "${batch}    close }\n")
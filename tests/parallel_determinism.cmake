@@ -0,0 +1,50 @@
+# Checks that parallel code generation is byte-identical to serial mode, with
+# and without cycle instrumentation.
+# Usage: cmake -DKAT_COMPILER=<path> -DWORK_DIR=<dir> -DJOBS=<n> -P parallel_determinism.cmake
+
+file(REMOVE_RECURSE ${WORK_DIR})
+file(MAKE_DIRECTORY ${WORK_DIR})
+
+execute_process(
+    COMMAND ${CMAKE_COMMAND} -DKAT_FILE=${WORK_DIR}/large.kat -DSTATEMENTS=40000
+            -P ${CMAKE_CURRENT_LIST_DIR}/generate_large_kat.cmake
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Failed to generate large.kat")
+endif()
+
+function(compile jobs flags asm_file)
+    execute_process(
+        COMMAND ${KAT_COMPILER} --jobs ${jobs} --time-codegen ${flags} large.kat
+        WORKING_DIRECTORY ${WORK_DIR}
+        OUTPUT_VARIABLE output
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "kat_compiler --jobs ${jobs} ${flags} failed")
+    endif()
+
+    string(REGEX MATCH "Code generation used ([0-9]+) chunk" chunk_line "${output}")
+    if(NOT chunk_line)
+        message(FATAL_ERROR "kat_compiler --jobs ${jobs} ${flags} did not report its chunk count:\n${output}")
+    endif()
+    if(jobs GREATER 1 AND CMAKE_MATCH_1 LESS 2)
+        message(FATAL_ERROR "kat_compiler --jobs ${jobs} did not split the program into chunks")
+    endif()
+    file(RENAME ${WORK_DIR}/program.asm ${WORK_DIR}/${asm_file})
+endfunction()
+
+foreach(flags "" "--instrument-cycles")
+    compile(1 "${flags}" serial.asm)
+    compile(${JOBS} "${flags}" parallel.asm)
+
+    execute_process(
+        COMMAND ${CMAKE_COMMAND} -E compare_files ${WORK_DIR}/serial.asm ${WORK_DIR}/parallel.asm
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "--jobs ${JOBS} ${flags} output differs from --jobs 1")
+    endif()
+    message(STATUS "--jobs ${JOBS} ${flags} output matches --jobs 1")
+endforeach()
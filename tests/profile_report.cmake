@@ -0,0 +1,27 @@
+# Checks kat_compiler --report against an expected report, or that it rejects
+# the profile with an error matching EXPECTED_ERROR.
+# Usage: cmake -DKAT_COMPILER=<path> -DPROFILE=<file.prof>
+#              (-DEXPECTED=<file> | -DEXPECTED_ERROR=<regex>) -P profile_report.cmake
+
+execute_process(
+    COMMAND ${KAT_COMPILER} --report ${PROFILE}
+    OUTPUT_VARIABLE output
+    ERROR_VARIABLE error
+    RESULT_VARIABLE result
+)
+
+if(EXPECTED_ERROR)
+    if(result EQUAL 0 OR NOT error MATCHES "${EXPECTED_ERROR}")
+        message(FATAL_ERROR "Expected --report ${PROFILE} to fail with '${EXPECTED_ERROR}', got:\n${output}${error}")
+    endif()
+    return()
+endif()
+
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "kat_compiler --report ${PROFILE} failed:\n${error}")
+endif()
+
+file(READ ${EXPECTED} expected)
+if(NOT output STREQUAL expected)
+    message(FATAL_ERROR "--report ${PROFILE} printed:\n${output}\nexpected:\n${expected}")
+endif()